@@ -0,0 +1,200 @@
+// async_test.cpp
+
+#include "clang_parser.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::cerr << __FILE__ << ':' << __LINE__                                 \
+                << ": check failed: " #condition << std::endl;                 \
+      ++failures;                                                              \
+    }                                                                          \
+  } while (false)
+
+#define COUNT_OF_CALLERS 4
+
+std::atomic<int> failures{0};
+
+const QString declaration_file{SOURCE_DIR "/simple_class_declaration.hpp"};
+const QString template_file{SOURCE_DIR "/simple_class_template.hpp"};
+const QString missing_file{SOURCE_DIR "/not_existing_file.hpp"};
+
+void check_declaration(const std::list<interface_description> &descriptions) {
+  CHECK(descriptions.size() == 2);
+  if (descriptions.size() != 2) {
+    return;
+  }
+  CHECK(descriptions.front().header == declaration_file);
+  CHECK(descriptions.front().interface_class == "other_class");
+  CHECK(descriptions.front().methods.size() == 1);
+  CHECK(descriptions.back().interface_class ==
+        "general::my_namespace::simple");
+  CHECK(descriptions.back().inheritance_classes.size() == 1);
+  CHECK(descriptions.back().methods.size() == 7);
+}
+
+void check_template(const std::list<interface_description> &descriptions) {
+  CHECK(descriptions.size() == 1);
+  if (descriptions.size() != 1) {
+    return;
+  }
+  CHECK(descriptions.front().header == template_file);
+  CHECK(descriptions.front().interface_class ==
+        "general::simple_class_template<T,T2>");
+  CHECK(descriptions.front().methods.size() == 1);
+  CHECK(descriptions.front().methods.front().type == method_struct::type::pure);
+}
+
+void check_missing(const std::exception_ptr &error) {
+  CHECK(error);
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::runtime_error &) {
+  } catch (...) {
+    CHECK(false);
+  }
+}
+
+void check_futures(const clang_parser &parser) {
+  auto futures = parser.create_descriptions_async(
+      QStringList{} << declaration_file << template_file << missing_file);
+  CHECK(futures.size() == 3);
+  auto iter = futures.begin();
+  check_declaration(iter->get());
+  check_template((++iter)->get());
+  try {
+    (++iter)->get();
+    CHECK(false);
+  } catch (...) {
+    check_missing(std::current_exception());
+  }
+}
+
+void check_handler(const clang_parser &parser) {
+  std::atomic<int> handled{0};
+  auto finished = parser.create_descriptions_async(
+      QStringList{} << declaration_file << template_file << missing_file,
+      QStringList{},
+      [&handled, &parser](const QString &file_name,
+                          std::list<interface_description> descriptions,
+                          std::exception_ptr error) {
+        if (file_name == declaration_file) {
+          CHECK(!error);
+          check_declaration(descriptions);
+          // waiting from worker must not block the pool
+          check_template(parser.create_description_async(template_file).get());
+        } else if (file_name == template_file) {
+          CHECK(!error);
+          check_template(descriptions);
+        } else {
+          CHECK(file_name == missing_file);
+          CHECK(descriptions.empty());
+          check_missing(error);
+        }
+        ++handled;
+      });
+  finished.get();
+  CHECK(handled == 3);
+
+  // exception from handler must not break the pool
+  parser
+      .create_descriptions_async(QStringList{} << template_file, QStringList{},
+                                 [](const QString &,
+                                    std::list<interface_description>,
+                                    std::exception_ptr) {
+                                   throw std::runtime_error{"handler error"};
+                                 })
+      .get();
+  check_template(parser.create_description_async(template_file).get());
+}
+
+void check_stop(const clang_parser &parser) {
+  std::atomic<bool> started{false};
+  std::atomic<bool> finished{false};
+  std::atomic<bool> wait_refused{false};
+  auto batch = parser.create_descriptions_async(
+      QStringList{} << template_file, QStringList{},
+      [&started, &finished, &wait_refused](const QString &,
+                                           std::list<interface_description>,
+                                           std::exception_ptr) {
+        started = true;
+        try {
+          clang_parser::wait_for_async_tasks();
+        } catch (const std::logic_error &) {
+          wait_refused = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+        finished = true;
+      });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  // every call of stop has to return only after the handler finished
+  std::vector<std::thread> stoppers;
+  for (int i{}; i < 2; ++i) {
+    stoppers.emplace_back([&finished]() {
+      clang_parser::stop_async_tasks();
+      CHECK(finished);
+    });
+  }
+  for (auto &i : stoppers) {
+    i.join();
+  }
+  batch.get();
+  CHECK(wait_refused);
+
+  // after stop no one task can be added
+  std::atomic<int> handled{0};
+  try {
+    parser.create_descriptions_async(
+        QStringList{} << declaration_file << template_file, QStringList{},
+        [&handled](const QString &, std::list<interface_description>,
+                   std::exception_ptr) { ++handled; });
+    CHECK(false);
+  } catch (const std::runtime_error &) {
+  }
+  try {
+    parser.create_description_async(template_file);
+    CHECK(false);
+  } catch (const std::runtime_error &) {
+  }
+  CHECK(handled == 0);
+}
+
+int main() {
+  clang_parser parser{};
+
+  std::vector<std::thread> callers;
+  for (int i{}; i < COUNT_OF_CALLERS; ++i) {
+    callers.emplace_back([&parser]() {
+      check_futures(parser);
+      check_handler(parser);
+    });
+  }
+  for (auto &i : callers) {
+    i.join();
+  }
+
+  CHECK(parser.create_descriptions_async(QStringList{}, QStringList{},
+                                         [](const QString &,
+                                            std::list<interface_description>,
+                                            std::exception_ptr) {})
+            .wait_for(std::chrono::seconds{0}) == std::future_status::ready);
+
+  clang_parser::wait_for_async_tasks();
+  check_stop(parser);
+
+  if (failures != 0) {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -1,11 +1,15 @@
 // clang_parser.cpp
 
 #include "clang_parser.hpp"
+#include "worker_pool.hpp"
 #include <QDomDocument>
 #include <QFile>
 #include <QTextStream>
 #include <clang-c/Index.h>
+#include <atomic>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 #define INTERF_SCHEMA ":/component_schema.xsd"
 #define ROOT_NODE "description"
@@ -54,13 +58,39 @@ struct lock_ast {
   CXTranslationUnit unit;
 };
 
+// state of one call of create_descriptions_async with handler
+struct handler_batch {
+  explicit handler_batch(std::size_t count) : remaining{count} {}
+  std::atomic<std::size_t> remaining;
+  std::promise<void> finished;
+};
+
+/**\return pool of workers, which is shared by all clang_parser objects. It
+ * will be created at first call*/
+worker_pool &get_worker_pool();
+
+/**\return task, which parses file_name and sets result (or exception) in
+ * future*/
+worker_pool::task
+make_description_task(const clang_parser &parser, const QString &file_name,
+                      const QStringList &include_directories,
+                      std::future<std::list<interface_description>> &future);
+
+/**\brief add all tasks in shared pool at once, so if the pool is stopped, then
+ * no one task will be added. If current thread is worker of the pool, then
+ * tasks are executed right here, because the caller can wait for result, and
+ * if all workers will wait, then nobody will execute the tasks
+ * \except if the pool is stopped
+ * */
+void run_async(std::vector<worker_pool::task> tasks);
+
 clang_parser::clang_parser() {}
 
 clang_parser::~clang_parser() {}
 
 std::list<interface_description>
-clang_parser::create_description_from(const QString &file_name,
-                                      const QStringList &include_directories) {
+clang_parser::create_description_from(
+    const QString &file_name, const QStringList &include_directories) const {
   // return value
   std::list<interface_description> list_of_interfaces;
 
@@ -146,6 +176,79 @@ clang_parser::create_description_from(const QString &file_name,
   return list_of_interfaces;
 }
 
+std::future<std::list<interface_description>>
+clang_parser::create_description_async(
+    const QString &file_name, const QStringList &include_directories) const {
+  std::future<std::list<interface_description>> retval;
+  run_async(std::vector<worker_pool::task>{
+      make_description_task(*this, file_name, include_directories, retval)});
+  return retval;
+}
+
+std::list<std::future<std::list<interface_description>>>
+clang_parser::create_descriptions_async(
+    const QStringList &file_names,
+    const QStringList &include_directories) const {
+  std::list<std::future<std::list<interface_description>>> retval;
+  std::vector<worker_pool::task> tasks;
+  for (const auto &i : file_names) {
+    retval.push_back(std::future<std::list<interface_description>>{});
+    tasks.push_back(
+        make_description_task(*this, i, include_directories, retval.back()));
+  }
+  run_async(std::move(tasks));
+  return retval;
+}
+
+std::future<void> clang_parser::create_descriptions_async(
+    const QStringList &file_names, const QStringList &include_directories,
+    description_handler handler) const {
+  if (!handler) {
+    throw std::invalid_argument{"handler is void"};
+  }
+
+  // if the pool will discard some tasks, then the batch will be destroyed
+  // without value, so the future will get broken_promise
+  auto batch = std::make_shared<handler_batch>(file_names.size());
+  auto retval = batch->finished.get_future();
+  if (file_names.isEmpty()) {
+    batch->finished.set_value();
+    return retval;
+  }
+
+  clang_parser parser{*this};
+  std::vector<worker_pool::task> tasks;
+  for (const auto &i : file_names) {
+    tasks.push_back([parser, i, include_directories, handler, batch]() {
+      std::list<interface_description> descriptions;
+      std::exception_ptr error;
+      try {
+        descriptions = parser.create_description_from(i, include_directories);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      try {
+        handler(i, std::move(descriptions), error);
+      } catch (...) {
+        // nobody can catch exception from handler in worker, so we ignore it
+      }
+
+      if (--batch->remaining == 0) {
+        batch->finished.set_value();
+      }
+    });
+  }
+  // all tasks are added at once, so if the pool is stopped, then no one
+  // handler will be called after the exception
+  run_async(std::move(tasks));
+  return retval;
+}
+
+void clang_parser::wait_for_async_tasks() { get_worker_pool().wait(); }
+
+void clang_parser::stop_async_tasks() { get_worker_pool().stop(); }
+
 bool clang_parser::generate_xml_file(const interface_description &description,
                                      const QDir &dir) const {
   if (!dir.exists()) {
@@ -516,3 +619,36 @@ QString get_spelling_string(const CXSourceLocation location) {
   ::clang_disposeString(str);
   return retval;
 }
+
+worker_pool &get_worker_pool() {
+  // initialization of local static is thread-safe
+  static worker_pool pool;
+  return pool;
+}
+
+worker_pool::task
+make_description_task(const clang_parser &parser, const QString &file_name,
+                      const QStringList &include_directories,
+                      std::future<std::list<interface_description>> &future) {
+  // packaged_task is not copyable, but std::function need copyable object.
+  // The task can outlive the parser, so we capture copy of it
+  auto task =
+      std::make_shared<std::packaged_task<std::list<interface_description>()>>(
+          [parser, file_name, include_directories]() {
+            return parser.create_description_from(file_name,
+                                                  include_directories);
+          });
+  future = task->get_future();
+  return [task]() { (*task)(); };
+}
+
+void run_async(std::vector<worker_pool::task> tasks) {
+  worker_pool &pool = get_worker_pool();
+  if (pool.is_worker_thread()) {
+    for (auto &i : tasks) {
+      i();
+    }
+  } else {
+    pool.add_tasks(std::move(tasks));
+  }
+}
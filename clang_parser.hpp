@@ -7,11 +7,33 @@
 #include <QString>
 #include <QStringList>
 #include <clang-c/Index.h>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
 
 /**\brief this class parse header file, and create xml file(s) with description
-of classes in the header*/
+of classes in the header. The class has no state, so all methods can be called
+from several threads at once. Asynchronous methods use one internal pool of
+workers, which is shared by all objects of this class. Tasks and handlers are
+executed by workers of the pool. If asynchronous method is called from worker
+(for example, from handler), then parsing is executed right in the call, so
+waiting for result from worker can not block the pool*/
 class clang_parser {
 public:
+  /**\brief calls from worker of the pool, when parsing of file_name is
+   * finished. If parsing failed, then descriptions will be void and error will
+   * have exception, which was be thrown by create_description_from. Exceptions
+   * thrown by handler are ignored. Handler can call asynchronous methods (they
+   * will be executed right in the handler), but must not call
+   * wait_for_async_tasks or stop_async_tasks: they throw std::logic_error in
+   * worker. If handler calls std::exit, then other workers finish their
+   * current tasks and the rest of tasks are discarded*/
+  using description_handler =
+      std::function<void(const QString &file_name,
+                         std::list<interface_description> descriptions,
+                         std::exception_ptr error)>;
+
   clang_parser();
   ~clang_parser();
 
@@ -25,7 +47,57 @@ public:
    * */
   std::list<interface_description> create_description_from(
       const QString &file_name,
-      const QStringList &include_directories = QStringList{});
+      const QStringList &include_directories = QStringList{}) const;
+
+  /**\brief same as create_description_from, but parsing will be executed in
+   * internal worker pool
+   * \return future, which will get list of descriptions, or exception if
+   * couldn't build correct ast tree. If the pool was stopped before parsing,
+   * then future will get std::future_error with broken_promise
+   * \except if the pool is stopped
+   * */
+  std::future<std::list<interface_description>> create_description_async(
+      const QString &file_name,
+      const QStringList &include_directories = QStringList{}) const;
+
+  /**\brief parse every file from file_names in internal worker pool
+   * \return futures in same order as file_names
+   * \param include_directories common for all files
+   * \except if the pool is stopped. All files are added in the pool at once,
+   * so in this case no one file will be parsed
+   * */
+  std::list<std::future<std::list<interface_description>>>
+  create_descriptions_async(
+      const QStringList &file_names,
+      const QStringList &include_directories = QStringList{}) const;
+
+  /**\brief parse every file from file_names in internal worker pool and call
+   * handler for every file, as soon as it will be parsed. Order of calls is
+   * not defined
+   * \return future, which will be ready after the last handler returns. If the
+   * pool was stopped before all files were parsed, then future will get
+   * std::future_error with broken_promise
+   * \param include_directories common for all files
+   * \except if the pool is stopped, or if handler is void. All files are added
+   * in the pool at once, so in this case the handler will not be called
+   * */
+  std::future<void> create_descriptions_async(
+      const QStringList &file_names, const QStringList &include_directories,
+      description_handler handler) const;
+
+  /**\brief block until all asynchronous tasks will be finished
+   * \except if called from worker of the pool (for example, from handler)
+   * */
+  static void wait_for_async_tasks();
+
+  /**\brief finish current asynchronous tasks and discard other. Returns only
+   * after all current tasks (and handlers) finished, even if it is called from
+   * several threads at once. After that asynchronous methods can not be used.
+   * Call it before exit from main, if some tasks can be not finished,
+   * otherwise they will be discarded only while destruction of static objects
+   * \except if called from worker of the pool (for example, from handler)
+   * */
+  static void stop_async_tasks();
 
   /**\brief create xml file from interface_description and set it in dir. If
    * interface have namespaces, then file will be in folder, with name of
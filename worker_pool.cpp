@@ -0,0 +1,144 @@
+// worker_pool.cpp
+
+#include "worker_pool.hpp"
+#include <stdexcept>
+
+// pool, which owns current thread. For not worker threads it is nullptr
+thread_local const worker_pool *current_pool{nullptr};
+
+worker_pool::worker_pool(std::size_t count_of_workers)
+    : active_tasks_{0}, stop_{false} {
+  if (count_of_workers == 0) {
+    count_of_workers = std::thread::hardware_concurrency();
+  }
+  // hardware_concurrency can return 0, if it can not be computed
+  if (count_of_workers == 0) {
+    count_of_workers = 1;
+  }
+
+  workers_.reserve(count_of_workers);
+  try {
+    for (std::size_t i{}; i < count_of_workers; ++i) {
+      workers_.emplace_back(&worker_pool::work, this);
+    }
+  } catch (...) {
+    // destructor will not be called, so we have to join already started
+    // workers, otherwise std::thread destructor calls std::terminate
+    shutdown();
+    throw;
+  }
+}
+
+worker_pool::~worker_pool() { shutdown(); }
+
+void worker_pool::add_task(task new_task) {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (stop_) {
+      throw std::runtime_error{"worker pool is stopped"};
+    }
+    tasks_.push(std::move(new_task));
+  }
+  task_condition_.notify_one();
+}
+
+void worker_pool::add_tasks(std::vector<task> new_tasks) {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (stop_) {
+      throw std::runtime_error{"worker pool is stopped"};
+    }
+    for (auto &i : new_tasks) {
+      tasks_.push(std::move(i));
+    }
+  }
+  task_condition_.notify_all();
+}
+
+void worker_pool::wait() {
+  if (is_worker_thread()) {
+    throw std::logic_error{"worker can not wait for own pool"};
+  }
+  std::unique_lock<std::mutex> lock{mutex_};
+  finish_condition_.wait(
+      lock, [this]() { return tasks_.empty() && active_tasks_ == 0; });
+}
+
+void worker_pool::stop() {
+  if (is_worker_thread()) {
+    throw std::logic_error{"worker can not stop own pool"};
+  }
+  shutdown();
+}
+
+void worker_pool::shutdown() {
+  std::lock_guard<std::mutex> stop_lock{stop_mutex_};
+
+  std::queue<task> discarded_tasks;
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stop_ = true;
+    discarded_tasks.swap(tasks_);
+    workers.swap(workers_);
+  }
+  task_condition_.notify_all();
+  finish_condition_.notify_all();
+
+  for (auto &i : workers) {
+    if (i.get_id() == std::this_thread::get_id()) {
+      // destructor is called from the worker (for example, task calls
+      // std::exit), so it can not join itself. The worker never returns to
+      // the pool, because std::exit doesn't return
+      i.detach();
+    } else {
+      i.join();
+    }
+  }
+
+  // workers can be already joined by previous call, but current worker (if
+  // we are in it) still runs its task
+  std::size_t own_tasks = is_worker_thread() ? 1 : 0;
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    finish_condition_.wait(
+        lock, [this, own_tasks]() { return active_tasks_ <= own_tasks; });
+  }
+  // discarded tasks destroyed here, outside of lock, because their captured
+  // objects can do anything in destructors (for example, break promises)
+}
+
+bool worker_pool::is_worker_thread() const { return current_pool == this; }
+
+void worker_pool::work() {
+  current_pool = this;
+  while (true) {
+    task current_task;
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      task_condition_.wait(lock,
+                           [this]() { return stop_ || !tasks_.empty(); });
+      if (stop_) {
+        return;
+      }
+      current_task = std::move(tasks_.front());
+      tasks_.pop();
+      ++active_tasks_;
+    }
+
+    try {
+      current_task();
+    } catch (...) {
+      // nobody can catch the exception in worker thread, so we ignore it for
+      // keep the worker alive
+    }
+    // captured objects have to be destroyed before the task counts finished
+    current_task = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      --active_tasks_;
+    }
+    finish_condition_.notify_all();
+  }
+}
@@ -0,0 +1,73 @@
+// worker_pool.hpp
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**\brief simple fixed-size thread pool. Tasks are executed in order of
+ * adding, by first free worker. All methods are thread-safe*/
+class worker_pool {
+public:
+  using task = std::function<void()>;
+
+  /**\param count_of_workers if 0, then will be used count of hardware threads
+   * \except if couldn't start workers
+   * */
+  explicit worker_pool(std::size_t count_of_workers = 0);
+  /**\brief same as stop, but can be called from worker (for example, if task
+   * calls std::exit). In this case the worker is detached instead of join*/
+  ~worker_pool();
+
+  worker_pool(const worker_pool &) = delete;
+  worker_pool &operator=(const worker_pool &) = delete;
+
+  /**\brief add task in queue. Exceptions from task are ignored
+   * \except if pool is stopped
+   * */
+  void add_task(task new_task);
+
+  /**\brief add all tasks in queue at once. Exceptions from tasks are ignored
+   * \except if pool is stopped. In this case no one task will be added
+   * */
+  void add_tasks(std::vector<task> new_tasks);
+
+  /**\brief block until all added tasks will be finished
+   * \except if called from worker of this pool, because it will never return
+   * */
+  void wait();
+
+  /**\brief stop taking new tasks, discard tasks, which were not started, and
+   * join workers after they finish current tasks. If stop is called from
+   * several threads, then every call returns only after all current tasks
+   * finished
+   * \except if called from worker of this pool
+   * */
+  void stop();
+
+  /**\return true if current thread is worker of this pool*/
+  bool is_worker_thread() const;
+
+private:
+  void work();
+  void shutdown();
+
+private:
+  std::vector<std::thread> workers_;
+  std::queue<task> tasks_;
+  std::mutex mutex_;
+  // held while stopping, so other stop calls (and destructor) can not return
+  // while workers are joining
+  std::mutex stop_mutex_;
+  // notified when new task added or pool stopped
+  std::condition_variable task_condition_;
+  // notified when some task finished
+  std::condition_variable finish_condition_;
+  std::size_t active_tasks_;
+  bool stop_;
+};